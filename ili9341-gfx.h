@@ -34,6 +34,22 @@ typedef struct {
 	uint16_t height;
 } ili_sgfx_rgb565_bmp_t;
 
+/**
+ * Pixel formats accepted by the converting bitmap blit.
+ */
+typedef enum {
+	ILI_SGFX_FMT_RGB888 = 0,	///< 3 bytes per pixel in R, G, B order
+	ILI_SGFX_FMT_YUV422,	///< YUYV, 4 bytes per 2 pixels (Y0 U Y1 V), BT.601 limited range
+} ili_sgfx_pixel_fmt_t;
+
+typedef struct {
+	const uint8_t* data;	///< Source image data
+	uint16_t width;	///< Image width
+	uint16_t height;	///< Image height
+	uint32_t stride;	///< Bytes per source row, 0 for tightly packed rows
+	ili_sgfx_pixel_fmt_t format;	///< Source pixel format
+} ili_sgfx_color_bmp_t;
+
 typedef struct {
 
 } ili_sgfx_font_t;
@@ -249,6 +265,22 @@ void ili_sgfx_draw_pixmap_rect(const ili9341_desc_ptr_t desc, const ili_sgfx_bru
  */
 void ili_sgfx_draw_RGB565_bitmap(const ili9341_desc_ptr_t desc, coord_2d_t coord, const ili_sgfx_rgb565_bmp_t* bmp);
 
+/**
+ * Draw RGB888 or YUV422 bitmap, converting it to RGB565 on the fly.
+ *
+ * Source rows are converted chunk by chunk directly into the DMA transfer buffer
+ * in the panel byte order, so no RGB565 copy of the whole image is needed.
+ *
+ * If dither is set to True, 4x4 ordered (Bayer) dithering is applied while reducing
+ * the color depth, which removes banding in gradients at a small cost per pixel.
+ *
+ * @param [in] desc Display driver instance.
+ * @param [in] coord Top left corner from where the bitmap is drawn.
+ * @param [in] bmp Bitmap to be drawn.
+ * @param [in] dither If True, ordered dithering is applied during the conversion.
+ */
+void ili_sgfx_draw_color_bitmap(const ili9341_desc_ptr_t desc, coord_2d_t coord, const ili_sgfx_color_bmp_t* bmp, bool dither);
+
 /**
  * NOT YET IMPLEMENTED
  */
@@ -6,6 +6,7 @@
 
 #include "ili9341-gfx.h"
 #include "stdarg.h"
+#include <string.h>
 
 #define BUFFER_SIZE  (1024)
 #define MAX_RECT_SIZE (16*16)
@@ -77,6 +78,103 @@ uint32_t _ili_sgfx_draw_pixmap_chunk(const ili9341_desc_ptr_t desc, const ili_sg
 	return image_index;
 }
 
+/* 4x4 Bayer matrix, thresholds 0..15. */
+static const uint8_t _ili_sgfx_bayer4[4][4] = {
+		{ 0,  8,  2, 10},
+		{12,  4, 14,  6},
+		{ 3, 11,  1,  9},
+		{15,  7, 13,  5}
+};
+
+static inline uint8_t _ili_sgfx_clamp_u8(int32_t value) {
+	if (value < 0) {
+		return 0;
+	}
+	if (value > 255) {
+		return 255;
+	}
+	return value;
+}
+
+/* Threshold 0 disables dithering, the compiler folds the additions away. */
+static inline uint16_t _ili_sgfx_to_rgb565(uint8_t r, uint8_t g, uint8_t b, uint8_t threshold) {
+	r = _ili_sgfx_clamp_u8(r + (threshold >> 1));
+	g = _ili_sgfx_clamp_u8(g + (threshold >> 2));
+	b = _ili_sgfx_clamp_u8(b + (threshold >> 1));
+	return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+}
+
+/* Stores two pixels in the panel (big endian) byte order with a single word write. */
+static inline void _ili_sgfx_store_px_pair(uint8_t* dst, uint16_t px0, uint16_t px1) {
+	uint32_t word;
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+	word = ((uint32_t)px0 << 16) | px1;
+#else
+	word = (uint32_t)(px0 >> 8) | (uint32_t)(px0 & 0xFF) << 8
+			| (uint32_t)(px1 >> 8) << 16 | (uint32_t)(px1 & 0xFF) << 24;
+#endif
+	memcpy(dst, &word, sizeof(word));
+}
+
+void _ili_sgfx_convert_rgb888_row(const uint8_t* restrict src, uint8_t* restrict dst, uint16_t x, uint16_t y, uint16_t count, bool dither) {
+	const uint8_t* bayer_row = _ili_sgfx_bayer4[y & 3];
+	uint32_t pairs = count/2;
+
+	src += 3*x;
+	if (dither) {
+		for (uint32_t p = 0; p < pairs; p++) {
+			_ili_sgfx_store_px_pair(&dst[4*p],
+					_ili_sgfx_to_rgb565(src[6*p], src[6*p+1], src[6*p+2], bayer_row[(x+2*p) & 3]),
+					_ili_sgfx_to_rgb565(src[6*p+3], src[6*p+4], src[6*p+5], bayer_row[(x+2*p+1) & 3]));
+		}
+	}
+	else {
+		for (uint32_t p = 0; p < pairs; p++) {
+			_ili_sgfx_store_px_pair(&dst[4*p],
+					_ili_sgfx_to_rgb565(src[6*p], src[6*p+1], src[6*p+2], 0),
+					_ili_sgfx_to_rgb565(src[6*p+3], src[6*p+4], src[6*p+5], 0));
+		}
+	}
+	if (count & 1) {
+		uint32_t i = count - 1;
+		uint16_t px = _ili_sgfx_to_rgb565(src[3*i], src[3*i+1], src[3*i+2], dither ? bayer_row[(x+i) & 3] : 0);
+		dst[2*i] = px >> 8;
+		dst[2*i+1] = px & 0xFF;
+	}
+}
+
+/* x has to be even, YUYV macropixels cannot be split. */
+void _ili_sgfx_convert_yuv422_row(const uint8_t* restrict src, uint8_t* restrict dst, uint16_t x, uint16_t y, uint16_t count, bool dither) {
+	const uint8_t* bayer_row = _ili_sgfx_bayer4[y & 3];
+
+	src += 2*x;
+	for (uint16_t i = 0; i < count; i += 2, src += 4, dst += 4) {
+		/* BT.601 limited range, 8 bit fixed point. */
+		int32_t d = src[1] - 128;
+		int32_t e = src[3] - 128;
+		int32_t r_chroma = 409*e + 128;
+		int32_t g_chroma = -100*d - 208*e + 128;
+		int32_t b_chroma = 516*d + 128;
+		int32_t c0 = 298*(src[0] - 16);
+		int32_t c1 = 298*(src[2] - 16);
+		uint8_t t0 = dither ? bayer_row[(x+i) & 3] : 0;
+		uint8_t t1 = dither ? bayer_row[(x+i+1) & 3] : 0;
+
+		uint16_t px0 = _ili_sgfx_to_rgb565(_ili_sgfx_clamp_u8((c0 + r_chroma) >> 8),
+				_ili_sgfx_clamp_u8((c0 + g_chroma) >> 8),
+				_ili_sgfx_clamp_u8((c0 + b_chroma) >> 8), t0);
+		if (i + 1 >= count) {
+			dst[0] = px0 >> 8;
+			dst[1] = px0 & 0xFF;
+			break;
+		}
+		uint16_t px1 = _ili_sgfx_to_rgb565(_ili_sgfx_clamp_u8((c1 + r_chroma) >> 8),
+				_ili_sgfx_clamp_u8((c1 + g_chroma) >> 8),
+				_ili_sgfx_clamp_u8((c1 + b_chroma) >> 8), t1);
+		_ili_sgfx_store_px_pair(dst, px0, px1);
+	}
+}
+
 /* Public functions definition */
 
 void ili_sgfx_clear_screen(const ili9341_desc_ptr_t desc, const ili_sgfx_brush_t* brush) {
@@ -336,6 +434,63 @@ void ili_sgfx_draw_RGB565_bitmap(const ili9341_desc_ptr_t desc, coord_2d_t coord
 	ili9341_draw_RGB565_dma(desc, bmp->data, size);
 }
 
+void ili_sgfx_draw_color_bitmap(const ili9341_desc_ptr_t desc, coord_2d_t coord, const ili_sgfx_color_bmp_t* bmp, bool dither) {
+	if (bmp->width == 0 || bmp->height == 0) {
+		return;
+	}
+
+	uint32_t stride = bmp->stride;
+	if (stride == 0) {
+		if (bmp->format == ILI_SGFX_FMT_YUV422) {
+			stride = ((bmp->width + 1)/2)*4;
+		}
+		else {
+			stride = bmp->width*3;
+		}
+	}
+
+	coord_2d_t top_left, bottom_right;
+	top_left = coord;
+	bottom_right.x = top_left.x + bmp->width - 1;
+	bottom_right.y = top_left.y + bmp->height - 1;
+	ili9341_set_region(desc, top_left, bottom_right);
+
+	uint8_t buffer[BUFFER_SIZE];
+	uint32_t filled = 0;
+
+	for (uint16_t y = 0; y < bmp->height; y++) {
+		const uint8_t* row = bmp->data + y*stride;
+		uint16_t x = 0;
+		while (x < bmp->width) {
+			uint32_t count = (BUFFER_SIZE - filled)/2;
+			if (bmp->format == ILI_SGFX_FMT_YUV422) {
+				/* Rows may be split only between YUYV macropixels. */
+				count &= ~1u;
+			}
+			if (count == 0) {
+				ili9341_draw_RGB565_dma(desc, buffer, filled);
+				filled = 0;
+				continue;
+			}
+			if (count > (uint32_t)(bmp->width - x)) {
+				count = bmp->width - x;
+			}
+
+			if (bmp->format == ILI_SGFX_FMT_YUV422) {
+				_ili_sgfx_convert_yuv422_row(row, buffer + filled, x, y, count, dither);
+			}
+			else {
+				_ili_sgfx_convert_rgb888_row(row, buffer + filled, x, y, count, dither);
+			}
+			filled += count*2;
+			x += count;
+		}
+	}
+	if (filled > 0) {
+		ili9341_draw_RGB565_dma(desc, buffer, filled);
+	}
+}
+
 
 uint8_t ili_sgfx_putc(const ili9341_desc_ptr_t desc, const ili_sgfx_brush_t* brush, coord_2d_t coord, const lw_font_t* font, bool transparent, wchar_t c) {
 
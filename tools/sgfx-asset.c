@@ -0,0 +1,345 @@
+/*
+ * Host-side asset compiler for ili9341-simple-gfx.
+ *
+ * Converts images into C sources in the exact layout consumed by
+ * the drawing functions, so no conversion is done on the target.
+ *
+ * Build (host compiler): cc -std=c99 -O2 -o sgfx-asset tools/sgfx-asset.c
+ *
+ * Usage:
+ *   sgfx-asset rgb565 <input.ppm> <name> [-o out.c] [-H out.h]
+ *   sgfx-asset pixmap <input.pbm|pgm|ppm> <name> [-o out.c] [-H out.h] [-t threshold] [-i] [-a]
+ *
+ * Author: Michal Horn
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <ctype.h>
+
+#define LINE_MAX_LEN (512)
+#define BYTES_PER_LINE (16)
+
+typedef struct {
+	uint8_t* rgb;	///< RGB888 pixels, rows tightly packed
+	uint32_t width;
+	uint32_t height;
+	bool bilevel;	///< PBM input, black pixels are ink
+} image_t;
+
+typedef struct {
+	const char* out_path;
+	const char* header_path;
+	int threshold;
+	bool inverted;
+	bool align_rows;
+} options_t;
+
+static void die(const char* msg, const char* arg) {
+	fprintf(stderr, "sgfx-asset: %s%s%s\n", msg, arg ? ": " : "", arg ? arg : "");
+	exit(EXIT_FAILURE);
+}
+
+static void* xmalloc(size_t size) {
+	void* ptr = calloc(1, size ? size : 1);
+	if (ptr == NULL) {
+		die("out of memory", NULL);
+	}
+	return ptr;
+}
+
+/* Image input */
+
+static int pnm_skip_space(FILE* f) {
+	int c = fgetc(f);
+	while (c != EOF) {
+		if (c == '#') {
+			while (c != EOF && c != '\n') {
+				c = fgetc(f);
+			}
+		}
+		else if (!isspace(c)) {
+			break;
+		}
+		c = fgetc(f);
+	}
+	return c;
+}
+
+static uint32_t pnm_read_uint(FILE* f) {
+	int c = pnm_skip_space(f);
+	uint32_t value = 0;
+	if (!isdigit(c)) {
+		die("malformed PNM header", NULL);
+	}
+	while (isdigit(c)) {
+		value = value*10 + (c - '0');
+		c = fgetc(f);
+	}
+	return value;
+}
+
+/* Reads binary PBM (P4), PGM (P5) or PPM (P6) and expands it to RGB888. */
+static image_t load_pnm(const char* path) {
+	image_t img = {0};
+	FILE* f = fopen(path, "rb");
+	if (f == NULL) {
+		die("cannot open", path);
+	}
+
+	char magic[2];
+	if (fread(magic, 1, 2, f) != 2 || magic[0] != 'P' || magic[1] < '4' || magic[1] > '6') {
+		die("not a binary PBM/PGM/PPM file (convert PNG inputs first)", path);
+	}
+	img.width = pnm_read_uint(f);
+	img.height = pnm_read_uint(f);
+	uint32_t maxval = 1;
+	if (magic[1] != '4') {
+		maxval = pnm_read_uint(f);
+		if (maxval == 0 || maxval > 255) {
+			die("only 8 bit PNM files are supported", path);
+		}
+	}
+	/* Exactly one whitespace follows the header and was consumed by pnm_read_uint. */
+
+	if (img.width == 0 || img.height == 0 || img.width > 0xFFFF || img.height > 0xFFFF) {
+		die("invalid image size", path);
+	}
+	size_t pixels = (size_t)img.width*img.height;
+	img.rgb = xmalloc(pixels*3);
+
+	if (magic[1] == '4') {
+		img.bilevel = true;
+		uint32_t row_bytes = (img.width + 7)/8;
+		uint8_t* row = xmalloc(row_bytes);
+		for (uint32_t y = 0; y < img.height; y++) {
+			if (fread(row, 1, row_bytes, f) != row_bytes) {
+				die("truncated image", path);
+			}
+			for (uint32_t x = 0; x < img.width; x++) {
+				/* PBM: 1 is black. */
+				uint8_t v = (row[x/8] & (0x80 >> (x%8))) ? 0 : 255;
+				memset(&img.rgb[(y*img.width + x)*3], v, 3);
+			}
+		}
+		free(row);
+	}
+	else {
+		uint32_t channels = (magic[1] == '6') ? 3 : 1;
+		for (size_t i = 0; i < pixels; i++) {
+			uint8_t px[3];
+			if (fread(px, 1, channels, f) != channels) {
+				die("truncated image", path);
+			}
+			for (uint32_t ch = 0; ch < 3; ch++) {
+				uint32_t v = px[channels == 3 ? ch : 0];
+				img.rgb[i*3 + ch] = (v*255 + maxval/2)/maxval;
+			}
+		}
+	}
+	fclose(f);
+	return img;
+}
+
+/* Output helpers */
+
+static FILE* open_output(const options_t* opt) {
+	if (opt->out_path == NULL) {
+		return stdout;
+	}
+	FILE* f = fopen(opt->out_path, "w");
+	if (f == NULL) {
+		die("cannot create", opt->out_path);
+	}
+	return f;
+}
+
+static void write_preamble(FILE* out, const char* input) {
+	fprintf(out, "/*\n * Generated by sgfx-asset from %s, do not edit.\n */\n\n", input);
+	fprintf(out, "#include \"ili9341-gfx.h\"\n\n");
+}
+
+/* Declares the generated asset for other translation units. */
+static void write_header(const options_t* opt, const char* name, const char* type) {
+	if (opt->header_path == NULL) {
+		return;
+	}
+	FILE* f = fopen(opt->header_path, "w");
+	if (f == NULL) {
+		die("cannot create", opt->header_path);
+	}
+
+	char guard[LINE_MAX_LEN];
+	snprintf(guard, sizeof(guard), "%s_H_", name);
+	for (char* c = guard; *c; c++) {
+		*c = isalnum((unsigned char)*c) ? toupper((unsigned char)*c) : '_';
+	}
+
+	fprintf(f, "/*\n * Generated by sgfx-asset, do not edit.\n */\n\n");
+	fprintf(f, "#ifndef %s\n#define %s\n\n", guard, guard);
+	fprintf(f, "#include \"ili9341-gfx.h\"\n\n");
+	fprintf(f, "extern const %s %s;\n\n", type, name);
+	fprintf(f, "#endif /* %s */\n", guard);
+	fclose(f);
+}
+
+static void write_bytes(FILE* out, const char* name, const uint8_t* data, size_t size) {
+	fprintf(out, "static const uint8_t %s[%zu] = {", name, size);
+	for (size_t i = 0; i < size; i++) {
+		if (i % BYTES_PER_LINE == 0) {
+			fprintf(out, "\n\t\t");
+		}
+		fprintf(out, "0x%02X%s", data[i], (i + 1 < size) ? ", " : "");
+	}
+	fprintf(out, "\n};\n\n");
+}
+
+/* Packs 1 byte per pixel data into the GLIB pixmap bit stream (LSB first, no row padding). */
+static size_t pack_pixmap(const uint8_t* bits, size_t count, uint8_t** packed) {
+	size_t size = (count + 7)/8;
+	*packed = xmalloc(size);
+	for (size_t i = 0; i < count; i++) {
+		if (bits[i]) {
+			(*packed)[i/8] |= 1 << (i%8);
+		}
+	}
+	return size;
+}
+
+/* Converters */
+
+static void compile_rgb565(const char* input, const char* name, const options_t* opt) {
+	image_t img = load_pnm(input);
+	size_t pixels = (size_t)img.width*img.height;
+	uint8_t* data = xmalloc(pixels*2);
+
+	/* Panel byte order, drawn by ili_sgfx_draw_RGB565_bitmap without any conversion. */
+	for (size_t i = 0; i < pixels; i++) {
+		const uint8_t* p = &img.rgb[i*3];
+		uint16_t px = ((p[0] & 0xF8) << 8) | ((p[1] & 0xFC) << 3) | (p[2] >> 3);
+		data[i*2] = px >> 8;
+		data[i*2 + 1] = px & 0xFF;
+	}
+
+	FILE* out = open_output(opt);
+	char data_name[LINE_MAX_LEN];
+	snprintf(data_name, sizeof(data_name), "%s_data", name);
+	write_preamble(out, input);
+	write_bytes(out, data_name, data, pixels*2);
+	fprintf(out, "const ili_sgfx_rgb565_bmp_t %s = {\n", name);
+	fprintf(out, "\t\t.data = (uint8_t*)%s,\n", data_name);
+	fprintf(out, "\t\t.width = %u,\n\t\t.height = %u\n};\n", img.width, img.height);
+	if (out != stdout) {
+		fclose(out);
+	}
+	write_header(opt, name, "ili_sgfx_rgb565_bmp_t");
+	free(data);
+	free(img.rgb);
+}
+
+static void compile_pixmap(const char* input, const char* name, const options_t* opt) {
+	image_t img = load_pnm(input);
+	/* Padding the width to whole bytes keeps every row byte aligned in the bit stream,
+	 * which is what ili_sgfx_draw_pixmap_rect expects when stepping between rows.
+	 * The padded width is what gets drawn, the padding is "off" pixels. */
+	uint32_t width = opt->align_rows ? (img.width + 7) & ~7u : img.width;
+	size_t count = (size_t)width*img.height;
+	uint8_t* bits = xmalloc(count);
+
+	for (uint32_t y = 0; y < img.height; y++) {
+		for (uint32_t x = 0; x < img.width; x++) {
+			const uint8_t* p = &img.rgb[(y*img.width + x)*3];
+			bool on;
+			if (img.bilevel) {
+				/* PBM set bits are ink, they are "on" regardless of the threshold. */
+				on = p[0] == 0;
+			}
+			else {
+				uint32_t luma = (p[0]*77 + p[1]*150 + p[2]*29) >> 8;
+				on = luma >= (uint32_t)opt->threshold;
+			}
+			bits[y*width + x] = on != opt->inverted;
+		}
+	}
+
+	uint8_t* packed;
+	size_t size = pack_pixmap(bits, count, &packed);
+
+	FILE* out = open_output(opt);
+	char data_name[LINE_MAX_LEN];
+	snprintf(data_name, sizeof(data_name), "%s_data", name);
+	write_preamble(out, input);
+	write_bytes(out, data_name, packed, size);
+	fprintf(out, "const ili_sgfx_pixmap_t %s = {\n", name);
+	fprintf(out, "\t\t.data = %s,\n", data_name);
+	fprintf(out, "\t\t.width = %u,\n\t\t.height = %u,\n", width, img.height);
+	fprintf(out, "\t\t.inverted = false\n};\n");
+	if (out != stdout) {
+		fclose(out);
+	}
+	write_header(opt, name, "ili_sgfx_pixmap_t");
+	free(packed);
+	free(bits);
+	free(img.rgb);
+}
+
+static void usage(void) {
+	fprintf(stderr,
+			"usage: sgfx-asset rgb565 <input.ppm> <name> [-o out.c] [-H out.h]\n"
+			"       sgfx-asset pixmap <input.pbm|pgm|ppm> <name> [-o out.c] [-H out.h] [-t threshold] [-i] [-a]\n"
+			"\n"
+			"  -o  output file, stdout by default\n"
+			"  -H  header declaring the generated asset\n"
+			"  -t  luminance threshold of \"on\" pixels, 128 by default, PBM ink is always \"on\"\n"
+			"  -i  invert pixmap, swaps \"on\" and \"off\" pixels\n"
+			"  -a  pad pixmap rows to whole bytes, the padded width is drawn\n");
+	exit(EXIT_FAILURE);
+}
+
+int main(int argc, char** argv) {
+	options_t opt = {
+			.out_path = NULL,
+			.header_path = NULL,
+			.threshold = 128,
+			.inverted = false,
+			.align_rows = false
+	};
+
+	if (argc < 4) {
+		usage();
+	}
+	for (int i = 4; i < argc; i++) {
+		if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+			opt.out_path = argv[++i];
+		}
+		else if (strcmp(argv[i], "-H") == 0 && i + 1 < argc) {
+			opt.header_path = argv[++i];
+		}
+		else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+			opt.threshold = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "-i") == 0) {
+			opt.inverted = true;
+		}
+		else if (strcmp(argv[i], "-a") == 0) {
+			opt.align_rows = true;
+		}
+		else {
+			usage();
+		}
+	}
+
+	if (strcmp(argv[1], "rgb565") == 0) {
+		compile_rgb565(argv[2], argv[3], &opt);
+	}
+	else if (strcmp(argv[1], "pixmap") == 0) {
+		compile_pixmap(argv[2], argv[3], &opt);
+	}
+	else {
+		usage();
+	}
+	return EXIT_SUCCESS;
+}